@@ -12,6 +12,7 @@
 #include <fstream>
 #include <string>
 #include <iostream>
+#include <chrono>
 
 void init_args(DarwinArgs& args, CLI::clipper& cli) {
     namespace pred = CLI::pred;
@@ -53,6 +54,32 @@ void init_args(DarwinArgs& args, CLI::clipper& cli) {
     cli.add_flag("--stdout", "-c")
         .set(args.writeout)
         .doc("Writes result to standard output");
+
+    cli.add_flag("--pareto", "-m")
+        .set(args.pareto)
+        .doc("Selects by Pareto ranking of fitness and genome length (NSGA-II), thresholds select a fraction of the population");
+
+    cli.add_flag("--stats", "-s")
+        .set(args.stats)
+        .doc("Writes statistics of every generation to standard log");
+
+    cli.add_option<uint32_t>("--stagnation")
+        .set("int", args.stop.stagnation, 0)
+        .doc("Stops after the given number of generations without fitness improvement");
+
+    cli.add_option<double>("--target")
+        .set("float", args.stop.target, std::numeric_limits<double>::infinity())
+        .doc("Stops when the given fitness is reached")
+        .require("in range [0; 1]", pred::ibetween<0., 1.>);
+
+    cli.add_option<double>("--time")
+        .set("float", args.stop.time, 0)
+        .doc("Stops after the given number of seconds")
+        .require("greater than 0", pred::greater_than<0.>);
+
+    cli.add_flag("--extinction", "-e")
+        .set(args.stop.extinction)
+        .doc("Stops when a whole generation dies out");
 }
 
 
@@ -70,22 +97,100 @@ int handle_parsing_errors(int argc, const CLI::clipper& cli) {
 }
 
 
-void simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, FitnessFunction f, Population& population) {
-    population.perform_selection(f, br_thr, ex_thr);
+namespace {
+
+/**
+ * \brief Common part of \ref simulate_evolution() "simulations"
+ * \tparam Select Function that performs selection on the given Population
+ * \param select Selection (single or multi-objective)
+ * \param pairs Number of pairs that will breed
+ * \param generations Maximal number of generations
+ * \param population Population to perform simulation on
+ * \param stop Criteria that end the simulation early
+ * \param observer Function called after every generation (\c nullptr - none)
+ * \return Number of simulated generations
+ */
+template<typename Select>
+uint32_t evolve(Select select, uint32_t pairs, uint32_t generations, Population& population,
+                const StopCriteria& stop, GenerationObserver observer) {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    select(population);
     population.determine_breeding();
 
-    if (population.get_breeding().size() < 2)
-        return;
+    if (observer)
+        observer(0, population.stats());
+
+    if (population.get_breeding().size() < 2 || population.stats().fitness_max >= stop.target)
+        return 0;
 
     Population new_generation;
     new_generation.data().reserve(pairs);
+    new_generation.recycle(true);
+
+    double best = population.stats().fitness_max;
+    uint32_t stagnant = 0;
 
-    for (uint32_t i = 0; i < generations; i++) {
+    uint32_t i = 0;
+    while (i < generations) {
         population.perform_breeding(pairs, new_generation);
-        new_generation.perform_selection(f, br_thr, ex_thr);
-        population.append(new_generation);
-        new_generation.data().clear();
+        select(new_generation);
+        new_generation.determine_breeding();
+
+        const PopulationStats st = new_generation.stats();
+        population.append(std::move(new_generation));
+        i++;
+
+        if (observer)
+            observer(i, st);
+
+        if (st.fitness_max > best) {
+            best = st.fitness_max;
+            stagnant = 0;
+        }
+        else
+            stagnant++;
+
+        // breeders are never removed from the population, so their number is checked only before the loop
+        if ((stop.extinction && 0 == st.survivors)
+            || (stop.stagnation && stagnant >= stop.stagnation)
+            || best >= stop.target
+            || (stop.time > 0 && std::chrono::duration<double>(clock::now() - start).count() >= stop.time))
+            break;
     }
+
+    return i;
+}
+
+} // namespace
+
+
+uint32_t simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, FitnessFunction f, Population& population,
+                            const StopCriteria& stop, GenerationObserver observer) {
+    auto select = [&](Population& p) { p.perform_selection(f, br_thr, ex_thr); };
+    return evolve(select, pairs, generations, population, stop, observer);
+}
+
+
+uint32_t simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, MultiFitnessFunction f, std::size_t objectives,
+                            Population& population, const StopCriteria& stop, GenerationObserver observer) {
+    auto select = [&](Population& p) { p.perform_selection(f, objectives, br_thr, ex_thr); };
+    return evolve(select, pairs, generations, population, stop, observer);
+}
+
+
+void write_stats(std::ostream *stream, uint32_t generation, const PopulationStats& st) {
+    if (!*stream)
+        return;
+
+    *stream << "gen " << generation
+            << " | evaluated " << st.evaluated
+            << " survivors " << st.survivors
+            << " breeders " << st.breeders
+            << " | fitness " << st.fitness_min << ' ' << st.fitness_mean << ' ' << st.fitness_max
+            << " | genome " << st.genome_min << ' ' << st.genome_mean << ' ' << st.genome_max
+            << " | diversity " << st.diversity << '\n';
 }
 
 
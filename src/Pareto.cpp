@@ -0,0 +1,293 @@
+/**
+ * \file Pareto.cpp
+ * \brief Implementation for multi-objective (Pareto) ranking utilities
+ * \author Paweł Rapacz
+ * \date 01-2025
+ */
+
+
+#include "Pareto.h"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <thread>
+#include <barrier>
+#include <cassert>
+
+
+namespace {
+
+/**
+ * \brief Checks whether \c a dominates \c b
+ * \param a Objective values
+ * \param b Objective values
+ * \param objectives Number of used objectives
+ * \return \c true if \c a is not worse in any objective and better in at least one
+ */
+bool dominates(const Scores& a, const Scores& b, std::size_t objectives) noexcept {
+    bool better = false;
+    for (std::size_t k = 0; k < objectives; k++) {
+        if (a[k] < b[k])
+            return false;
+        if (a[k] > b[k])
+            better = true;
+    }
+    return better;
+}
+
+
+/**
+ * \brief Runs phases of work, separated by a serial step, on multiple threads
+ *
+ * Threads are started once. Every phase each worker calls work(w, workers), then one thread calls step()
+ * while the others wait. Phases are repeated as long as step() returns \c true.
+ * If some threads cannot be started, the calling thread does their work as well.
+ *
+ * \param workers Number of workers (1 - everything runs on the calling thread)
+ * \param work Function called as work(worker, workers)
+ * \param step Function called between phases, returns \c true if another phase is needed
+ */
+template<typename Work, typename Step>
+void run_phases(std::size_t workers, Work work, Step step) {
+    if (workers <= 1) {
+        do
+            work(std::size_t { }, std::size_t { 1 });
+        while (step());
+        return;
+    }
+
+    bool more = true;
+    std::barrier sync(static_cast<std::ptrdiff_t>(workers), [&]() noexcept { more = step(); });
+
+    auto worker = [&](std::size_t w) {
+        do {
+            work(w, workers);
+            sync.arrive_and_wait();
+        } while (more);
+    };
+
+    std::vector<std::jthread> threads;
+    std::size_t started = 1;
+    try {
+        threads.reserve(workers - 1);
+        for (; started < workers; started++)
+            threads.emplace_back(worker, started);
+    }
+    catch (...) {
+        // the barrier must not wait for workers that do not exist
+        for (std::size_t w = started; w < workers; w++)
+            sync.arrive_and_drop();
+    }
+
+    do {
+        work(0, workers);
+        for (std::size_t w = started; w < workers; w++)
+            work(w, workers);
+        sync.arrive_and_wait();
+    } while (more);
+}
+
+
+/// \brief Number of comparisons worth a separate thread
+constexpr std::size_t parallel_work = 1 << 16;
+
+
+/// \brief \ref non_dominated_sort() for one or two objectives (sweep over the elements sorted by the first objective)
+std::size_t sweep_sort(const std::vector<Scores>& scores, std::size_t objectives, std::vector<uint32_t>& rank, ParetoBuffers& buf) {
+    auto second = [&](std::size_t i) { return objectives > 1 ? scores[i][1] : 0.; };
+
+    auto& order = buf.order;
+    order.resize(scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (scores[a][0] != scores[b][0])
+            return scores[a][0] > scores[b][0];
+        return second(a) > second(b);
+    });
+
+    // Members of a front are visited with increasing second objective, so the last one has the greatest.
+    // An element joins the first front whose last member is worse in the second objective (non-increasing over fronts).
+    auto& last = buf.last;
+    last.clear();
+    last.reserve(scores.size());
+    for (std::size_t k = 0; k < order.size(); k++) {
+        std::size_t i = order[k];
+
+        if (k && scores[i][0] == scores[order[k - 1]][0] && second(i) == second(order[k - 1])) {
+            rank[i] = rank[order[k - 1]]; // equal elements do not dominate each other
+            continue;
+        }
+
+        auto front = std::partition_point(last.begin(), last.end(), [&](double l) { return l >= second(i); });
+        rank[i] = static_cast<uint32_t>(front - last.begin());
+
+        if (last.end() == front)
+            last.push_back(second(i));
+        else
+            *front = second(i);
+    }
+
+    return last.size();
+}
+
+
+/// \brief \ref non_dominated_sort() for any number of objectives (peeling fronts using domination counts)
+std::size_t count_sort(const std::vector<Scores>& scores, std::size_t objectives, std::vector<uint32_t>& rank, ParetoBuffers& buf) {
+    const std::size_t n = scores.size();
+    if (0 == n)
+        return 0;
+
+    // In lexicographically descending order only preceding elements can dominate the following ones
+    auto& order = buf.order;
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return std::lexicographical_compare(scores[b].begin(), scores[b].begin() + objectives,
+                                            scores[a].begin(), scores[a].begin() + objectives);
+    });
+
+    auto& sorted = buf.sorted;
+    sorted.resize(n);
+    for (std::size_t p = 0; p < n; p++)
+        sorted[p] = scores[order[p]];
+
+    auto& count = buf.count;
+    auto& remaining = buf.remaining;
+    auto& front = buf.front;
+    count.resize(n);
+    remaining.resize(n);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    front.clear();
+    front.reserve(n);
+
+    bool counted = false;
+    uint32_t fronts = 0;
+
+    // Element k is handled by worker k % workers, so the work of every worker is similar
+    // although later elements have more predecessors to compare with.
+    auto work = [&](std::size_t w, std::size_t workers) {
+        if (!counted) {
+            for (std::size_t p = w; p < n; p += workers) {
+                uint32_t c = 0;
+                for (std::size_t q = 0; q < p; q++)
+                    c += dominates(sorted[q], sorted[p], objectives);
+                count[p] = c;
+            }
+            return;
+        }
+
+        for (std::size_t k = w; k < remaining.size(); k += workers)
+            for (std::size_t q : front) {
+                if (q > remaining[k])
+                    break;
+                count[remaining[k]] -= dominates(sorted[q], sorted[remaining[k]], objectives);
+            }
+    };
+
+    // moves elements that are no longer dominated to the next front (keeps both containers ordered)
+    auto peel = [&]() {
+        counted = true;
+        front.clear();
+
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < remaining.size(); k++) {
+            if (count[remaining[k]])
+                remaining[kept++] = remaining[k];
+            else
+                front.push_back(remaining[k]);
+        }
+        remaining.resize(kept);
+
+        if (front.empty()) // only possible with NaN objectives, which break transitivity
+            front.swap(remaining);
+
+        for (std::size_t p : front)
+            rank[order[p]] = fronts;
+        fronts++;
+
+        return not remaining.empty();
+    };
+
+    std::size_t workers = buf.threads ? buf.threads
+                        : std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), n / 2 * n / parallel_work);
+    run_phases(workers, work, peel);
+
+    return fronts;
+}
+
+} // namespace
+
+
+
+std::size_t non_dominated_sort(const std::vector<Scores>& scores, std::size_t objectives, std::vector<uint32_t>& rank, ParetoBuffers& buf) {
+    assert(objectives >= 1 && objectives <= max_objectives);
+    rank.resize(scores.size());
+
+    if (objectives <= 2)
+        return sweep_sort(scores, objectives, rank, buf);
+    return count_sort(scores, objectives, rank, buf);
+}
+
+
+void crowding_distance(const std::vector<Scores>& scores, std::size_t objectives, const std::vector<uint32_t>& rank,
+                       std::size_t fronts, std::vector<double>& dist, ParetoBuffers& buf) {
+    assert(objectives >= 1 && objectives <= max_objectives);
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    dist.assign(scores.size(), 0.);
+
+    // group the elements by fronts (counting sort)
+    auto& start = buf.start;
+    start.reserve(scores.size() + 1);
+    start.assign(fronts + 1, 0);
+    for (uint32_t r : rank)
+        start[r + 1]++;
+    std::partial_sum(start.begin(), start.end(), start.begin());
+
+    auto& members = buf.members;
+    auto& pos = buf.pos;
+    pos.reserve(scores.size());
+    members.resize(scores.size());
+    pos.assign(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < rank.size(); i++)
+        members[pos[rank[i]]++] = i;
+
+    for (std::size_t f = 0; f < fronts; f++) {
+        auto first = members.begin() + start[f];
+        auto last = members.begin() + start[f + 1];
+
+        for (std::size_t k = 0; k < objectives; k++) {
+            std::sort(first, last, [&](std::size_t a, std::size_t b) { return scores[a][k] < scores[b][k]; });
+
+            double lo = scores[*first][k];
+            double hi = scores[*(last - 1)][k];
+            dist[*first] = dist[*(last - 1)] = inf;
+
+            if (hi <= lo)
+                continue;
+
+            for (auto it = first + 1; it < last - 1; it++)
+                dist[*it] += (scores[*(it + 1)][k] - scores[*(it - 1)][k]) / (hi - lo);
+        }
+    }
+}
+
+
+void pareto_fitness(const std::vector<Scores>& scores, std::size_t objectives, std::vector<double>& ftns, ParetoBuffers& buf) {
+    auto& rank = buf.rank;
+    auto& dist = buf.dist;
+    std::size_t fronts = non_dominated_sort(scores, objectives, rank, buf);
+    crowding_distance(scores, objectives, rank, fronts, dist, buf);
+
+    auto& order = buf.order;
+    order.resize(scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (rank[a] != rank[b])
+            return rank[a] < rank[b];
+        return dist[a] > dist[b];
+    });
+
+    ftns.resize(scores.size());
+    for (std::size_t k = 0; k < order.size(); k++)
+        ftns[order[k]] = order.size() > 1 ? 1. - static_cast<double>(k) / (order.size() - 1) : 1.;
+}
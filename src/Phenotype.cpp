@@ -10,6 +10,7 @@
 #include <cmath>
 #include <random>
 #include <chrono>
+#include <sstream>
 
 
 Phenotype::Phenotype(std::string_view genome) {
@@ -29,6 +30,16 @@ Phenotype::Phenotype(const GenomeFrac& genome1, const GenomeFrac& genome2) {
 }
 
 
+Phenotype::Phenotype(const GenomeFrac& genome1, const GenomeFrac& genome2, Genome&& buffer)
+    : _gnm(std::move(buffer)) {
+    std::ptrdiff_t genome1_len = genome1.second - genome1.first;
+    std::ptrdiff_t genome2_len = genome2.second - genome2.first;
+    _gnm.reserve(genome1_len + genome2_len);
+    _gnm.assign(genome1.first, genome1.second);
+    _gnm.insert(_gnm.end(), genome2.first, genome2.second);
+}
+
+
 GenomeFrac Phenotype::frac_front() const {
     static std::default_random_engine rand(std::chrono::system_clock::now().time_since_epoch().count());
     std::uniform_int_distribution<> range(1, _gnm.size() - 1);
@@ -47,6 +58,10 @@ const Genome &Phenotype::genome() const noexcept
 { return _gnm; }
 
 
+Genome Phenotype::release_genome() noexcept
+{ return std::move(_gnm); }
+
+
 Adapt Phenotype::adapt() const noexcept
 { return _adapt; }
 
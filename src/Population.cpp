@@ -10,8 +10,94 @@
 #include <cstdint>
 #include <random>
 #include <chrono>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <cassert>
 
 
+namespace {
+
+/**
+ * \brief Estimates the number of distinct genomes from the \c K smallest genome hashes (bottom-k sketch)
+ * 
+ * Uses constant memory and a single pass, so it can be fed during \ref Population::perform_selection() "selection".
+ * \tparam K Number of kept hashes (larger is more accurate)
+ */
+template<std::size_t K>
+class DiversitySketch
+{
+    std::array<uint64_t, K> _min; ///< Max-heap of the smallest distinct hashes
+    std::size_t _len = 0; ///< Number of used elements of \c _min
+
+    /// \brief FNV-1a hash of a genome with a final avalanche, so that the values are spread uniformly
+    static uint64_t hash(const Genome& gnm) noexcept {
+        uint64_t h = 14695981039346656037ull;
+        for (Gene g : gnm) {
+            h ^= g;
+            h *= 1099511628211ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+public:
+    /// \brief Adds a genome to the sketch
+    void add(const Genome& gnm) noexcept {
+        uint64_t h = hash(gnm);
+        auto last = _min.begin() + _len;
+
+        if (_len == K && h >= _min.front())
+            return;
+        if (std::find(_min.begin(), last, h) != last)
+            return;
+
+        if (_len == K)
+            std::pop_heap(_min.begin(), last--);
+        else
+            _len++;
+
+        *last = h;
+        std::push_heap(_min.begin(), _min.begin() + _len);
+    }
+
+    /// \brief Estimated number of distinct genomes added so far
+    double estimate() const noexcept {
+        if (_len < K)
+            return static_cast<double>(_len);
+        return (K - 1) / (static_cast<double>(_min.front()) / std::numeric_limits<uint64_t>::max());
+    }
+};
+
+} // namespace
+
+
+
+Population::Population(const Population &other)
+    : _data(other._data), _br(other._br), _stats(other._stats), _recycle(other._recycle) { }
+
+
+Population &Population::operator=(const Population &other) {
+    if (this == &other)
+        return *this;
+
+    _data = other._data;
+    _br = other._br;
+    _stats = other._stats;
+    _recycle = other._recycle;
+
+    // scratch state belongs to the previous contents
+    _pool.clear();
+    _pool_len = 0;
+    _scores.clear();
+    _ftns.clear();
+    _pareto = { };
+    return *this;
+}
+
 
 Population &Population::operator+=(const Population &other) {
     std::size_t prvlen = _data.size();
@@ -22,6 +108,37 @@ Population &Population::operator+=(const Population &other) {
 }
 
 
+Population &Population::operator+=(Population &&other) {
+    std::size_t prvlen = _data.size();
+
+    if (other._recycle) {
+        // genomes get exactly sized copies, the (larger) buffers stay in the pool for the next descendants
+        other._pool.reserve(other._pool.size() + other._data.size());
+        for (auto& indv : other._data) {
+            _data.push_back(indv);
+            other._pool.push_back(indv.release_genome());
+        }
+    }
+    else
+        _data.insert(_data.end(), std::make_move_iterator(other._data.begin()), std::make_move_iterator(other._data.end()));
+
+    auto first = _br.insert(_br.end(), other._br.begin(), other._br.end());
+    std::for_each(first, _br.end(), [&prvlen](Index& idx) { idx += prvlen; });
+    other._data.clear();
+    other._br.clear();
+    return *this;
+}
+
+
+Population &Population::operator+=(PopulationVec &&range) {
+    std::size_t prevlen = _data.size();
+    _data.insert(_data.end(), std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+    range.clear();
+    determine_breeding(prevlen);
+    return *this;
+}
+
+
 Population &Population::operator+=(const PopulationVec &range) {
     std::size_t prevlen = _data.size();
     _data.insert(_data.end(), range.begin(), range.end());
@@ -38,6 +155,14 @@ Population& Population::append(const PopulationVec& range)
 { return *this += range; }
 
 
+Population& Population::append(Population&& other)
+{ return *this += std::move(other); }
+
+
+Population& Population::append(PopulationVec&& range)
+{ return *this += std::move(range); }
+
+
 Population Population::operator+(const Population &other) const {
     Population newp = *this;
     newp += other;
@@ -52,21 +177,93 @@ Population Population::operator+(const PopulationVec &range) const {
 }
 
 
-void Population::perform_selection(FitnessFunction f, const double &br_thr, const double &ex_thr)
+template<typename Fitness>
+void Population::select(Fitness fitness, const double &br_thr, const double &ex_thr)
 {
-    double ftns;
-    for (auto& indv : _data) {
-        ftns = f(indv.genome());
+    PopulationStats st;
+    st.evaluated = _data.size();
+    st.fitness_min = std::numeric_limits<double>::max();
+    st.fitness_max = std::numeric_limits<double>::lowest();
+    st.genome_min = std::numeric_limits<std::size_t>::max();
+
+    DiversitySketch<64> sketch;
+    double ftns_sum { };
+    std::size_t genome_sum { };
+
+    if (_recycle)
+        _pool.reserve(_pool.size() + _data.size());
+
+    auto alive = _data.begin();
+    for (Index i = 0; i < _data.size(); i++) {
+        auto& indv = _data[i];
+        auto [ftns, score] = fitness(i);
+        ftns_sum += score;
+        st.fitness_min = std::min(st.fitness_min, score);
+        st.fitness_max = std::max(st.fitness_max, score);
 
-        if (ftns < ex_thr)
+        if (ftns < ex_thr) {
             indv.adapt(Adapt::dead);
-        else if (ftns > br_thr)
+            if (_recycle) {
+                _pool.push_back(indv.release_genome());
+                _pool.back().reserve(_pool_len);
+            }
+            continue;
+        }
+        else if (ftns > br_thr) {
             indv.adapt(Adapt::breed);
+            st.breeders++;
+        }
         else
             indv.adapt(Adapt::nobreed);
+
+        std::size_t len = indv.genome().size();
+        genome_sum += len;
+        st.genome_min = std::min(st.genome_min, len);
+        st.genome_max = std::max(st.genome_max, len);
+        sketch.add(indv.genome());
+
+        if (&*alive != &indv)
+            *alive = std::move(indv);
+        ++alive;
     }
 
-    std::erase_if(_data, [](const Phenotype& p) -> bool { return Adapt::dead == p.adapt(); });
+    _data.erase(alive, _data.end());
+
+    st.survivors = _data.size();
+    st.diversity = sketch.estimate();
+
+    if (st.evaluated)
+        st.fitness_mean = ftns_sum / st.evaluated;
+    else
+        st.fitness_min = st.fitness_max = 0;
+
+    if (st.survivors)
+        st.genome_mean = static_cast<double>(genome_sum) / st.survivors;
+    else
+        st.genome_min = 0;
+
+    _stats = st;
+}
+
+
+void Population::perform_selection(FitnessFunction f, const double &br_thr, const double &ex_thr) {
+    select([&](Index i) {
+        double ftns = f(_data[i].genome());
+        return std::pair { ftns, ftns };
+    }, br_thr, ex_thr);
+}
+
+
+void Population::perform_selection(MultiFitnessFunction f, std::size_t objectives, const double &br_thr, const double &ex_thr) {
+    assert(objectives >= 1 && objectives <= max_objectives);
+
+    _scores.clear();
+    for (auto& indv : _data)
+        _scores.push_back(f(indv.genome()));
+
+    pareto_fitness(_scores, objectives, _ftns, _pareto);
+
+    select([&](Index i) { return std::pair { _ftns[i], _scores[i][0] }; }, br_thr, ex_thr);
 }
 
 
@@ -76,7 +273,7 @@ void Population::perform_breeding(std::size_t pairs, Population& other) const {
 
     other._data.reserve(pairs);
 
-    for (auto i = 0; i < pairs; i++) {
+    for (std::size_t i = 0; i < pairs; i++) {
         Index first = _br[range(rand)];
         Index second = _br[range(rand)];
 
@@ -85,7 +282,23 @@ void Population::perform_breeding(std::size_t pairs, Population& other) const {
             continue;
         }
 
-        other._data.emplace_back(_data[first].frac_front(), _data[second].frac_back());
+        GenomeFrac front = _data[first].frac_front();
+        GenomeFrac back = _data[second].frac_back();
+        std::size_t len = (front.second - front.first) + (back.second - back.first);
+        if (len > other._pool_len) // grown geometrically, so pooled buffers are rarely reallocated
+            other._pool_len = std::max(len, 2 * other._pool_len);
+
+        if (other._pool.empty() && !other._recycle)
+            other._data.emplace_back(front, back);
+        else if (other._pool.empty()) {
+            Genome buffer;
+            buffer.reserve(other._pool_len);
+            other._data.emplace_back(front, back, std::move(buffer));
+        }
+        else {
+            other._data.emplace_back(front, back, std::move(other._pool.back()));
+            other._pool.pop_back();
+        }
     }
 }
 
@@ -11,6 +11,37 @@
 #include "Phenotype.h"
 #include "Population.h"
 #include "clipper.hpp"
+#include <limits>
+#include <ostream>
+
+
+/**
+ * \brief Criteria that end the \ref simulate_evolution() "simulation" before all generations are simulated
+ * \headerfile ""
+ * 
+ * The simulation does not start when fewer than two \ref Phenotype "Phenotypes" can breed.
+ * Criteria are checked once per generation, against the \ref PopulationStats "statistics" of the new generation
+ * (in multi-objective simulation fitness means the first objective).
+ * 
+ * \see simulate_evolution() PopulationStats
+ */
+struct StopCriteria {
+    uint32_t stagnation = 0; ///< Number of generations without improvement of the best fitness after which the simulation stops (0 - disabled)
+    double target = std::numeric_limits<double>::infinity(); ///< Fitness value that ends the simulation once reached
+    double time = 0; ///< Wall-clock budget in seconds (0 - disabled)
+    bool extinction = false; ///< If \c true the simulation stops when no descendant of a generation survives the selection
+};
+
+
+/**
+ * \brief Type for a function called after every simulated generation
+ * 
+ * Receives the number of the generation (0 - selection of the initial population) and its
+ * \ref PopulationStats "statistics", e.g. to \ref write_stats() "write them" or to stop measuring a warm-up.
+ * 
+ * \see simulate_evolution() write_stats()
+ */
+using GenerationObserver = void (*)(uint32_t generation, const PopulationStats& st);
 
 
 /// \brief Container for program options
@@ -23,6 +54,9 @@ struct DarwinArgs {
     double w; ///< Extinction threshold
     double r; ///< Breeding threshold
     bool writeout; ///< If \c true the result should be written to standard output
+    bool pareto; ///< If \c true selection is multi-objective (fitness and genome length)
+    bool stats; ///< If \c true statistics of every generation should be written to standard log
+    StopCriteria stop; ///< Early termination criteria
 };
 
 
@@ -54,9 +88,43 @@ int handle_parsing_errors(int argc, const CLI::clipper& cli);
  * \param generations Number od generations (number of breeding operations that will be simulated)
  * \param f Function that checks phenotype fitness/adaptation (return values should be in range [0; 1])
  * \param smpl Population to perform simulation on
- * \see FitnessFunction Population
+ * \param stop Criteria that end the simulation early
+ * \param observer Function called after every generation (\c nullptr - none)
+ * \return Number of simulated generations
+ * \see FitnessFunction Population StopCriteria GenerationObserver
+ */
+uint32_t simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, FitnessFunction f, Population& smpl,
+                            const StopCriteria& stop = { }, GenerationObserver observer = nullptr);
+
+
+/**
+ * \brief Simulates breeding and multi-objective selection of its population using the \c MultiFitnessFunction
+ * \headerfile ""
+ * \param br_thr Breeding threshold [0; 1] (fraction of the Pareto ranking)
+ * \param ex_thr Extinctiom threshold [0; 1] (fraction of the Pareto ranking)
+ * \param pairs Number of pairs that will breed
+ * \param generations Number od generations (number of breeding operations that will be simulated)
+ * \param f Function that evaluates phenotype objectives
+ * \param objectives Number of used objectives [1; \ref max_objectives]
+ * \param smpl Population to perform simulation on
+ * \param stop Criteria that end the simulation early
+ * \param observer Function called after every generation (\c nullptr - none)
+ * \return Number of simulated generations
+ * \see MultiFitnessFunction Population StopCriteria GenerationObserver pareto_fitness()
+ */
+uint32_t simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, MultiFitnessFunction f, std::size_t objectives,
+                            Population& smpl, const StopCriteria& stop = { }, GenerationObserver observer = nullptr);
+
+
+/**
+ * \brief Writes generation statistics as a single line
+ * \headerfile ""
+ * \param[in] stream Output stream pointer to write to
+ * \param generation Number of the generation
+ * \param st Statistics to write
+ * \see PopulationStats
  */
-void simulate_evolution(double br_thr, double ex_thr, uint32_t pairs, uint32_t generations, FitnessFunction f, Population& smpl);
+void write_stats(std::ostream *stream, uint32_t generation, const PopulationStats& st);
 
 
 /**
@@ -0,0 +1,112 @@
+/**
+ * \file Pareto.h
+ * \brief Multi-objective (Pareto) ranking utilities
+ * \author Paweł Rapacz
+ * \date 01-2025
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+inline constexpr std::size_t max_objectives = 4; ///< Maximal number of objectives of a \ref Scores "multi-objective fitness"
+
+
+/**
+ * \brief Type for objective values of a single \ref Phenotype "Phenotype"
+ *
+ * Every objective is maximized. Only the first \c objectives values are used,
+ * the remaining ones are ignored.
+ *
+ * \see MultiFitnessFunction
+ */
+using Scores = std::array<double, max_objectives>;
+
+
+
+/**
+ * \brief Scratch memory of the Pareto ranking
+ *
+ * Keeping an instance between calls lets the ranking reuse its buffers, so once they have grown
+ * to the population size no further allocations are needed for one or two objectives.
+ * For more objectives large inputs are sorted in parallel, and every call starts and joins its own threads,
+ * which allocates.
+ *
+ * \see non_dominated_sort() crowding_distance() pareto_fitness()
+ */
+struct ParetoBuffers {
+    std::vector<uint32_t> rank; ///< Front index of every element (\ref pareto_fitness() only)
+    std::vector<double> dist; ///< Crowding distance of every element (\ref pareto_fitness() only)
+    std::vector<std::size_t> order; ///< Indexes of the elements in sorted order
+    std::vector<Scores> sorted; ///< Objective values in sorted order
+    std::vector<uint32_t> count; ///< Number of not yet ranked elements dominating every element
+    std::vector<std::size_t> remaining; ///< Elements that were not assigned to a front yet
+    std::vector<std::size_t> front; ///< Elements of the current front
+    std::vector<double> last; ///< Second objective of the last member of every front
+    std::vector<std::size_t> start; ///< Index of the first member of every front in \c members
+    std::vector<std::size_t> pos; ///< Insertion positions used while grouping \c members
+    std::vector<std::size_t> members; ///< Elements grouped by fronts
+    std::size_t threads = 0; ///< Number of threads sorting more than two objectives (0 - chosen by the amount of work and hardware concurrency)
+};
+
+
+
+/**
+ * \brief Assigns every element to a Pareto front (fast non-dominated sorting)
+ * \headerfile ""
+ *
+ * Element \c a dominates \c b if it is not worse in any objective and better in at least one.
+ * Front 0 contains elements that are not dominated, front 1 elements dominated only by front 0 and so on.
+ *
+ * \li For one or two objectives a sweep over the elements sorted by the first objective is used - O(N log N).
+ * \li For more objectives domination counts are computed in parallel - O(M N^2) work, O(N) memory.
+ *     Threads are started (and joined) on every call and work on interleaved elements, so the triangular work is spread evenly.
+ *
+ * \param[in] scores Objective values of the elements
+ * \param objectives Number of used objectives [1; \ref max_objectives]
+ * \param[out] rank Front index of every element
+ * \param buf Reusable scratch memory
+ * \return Number of fronts
+ */
+std::size_t non_dominated_sort(const std::vector<Scores>& scores, std::size_t objectives, std::vector<uint32_t>& rank, ParetoBuffers& buf);
+
+
+/**
+ * \brief Computes crowding distance of every element within its front (NSGA-II)
+ * \headerfile ""
+ *
+ * Boundary elements of every objective get infinite distance. Larger distance means a less crowded
+ * neighbourhood, which is preferred in order to keep the front diverse.
+ *
+ * \param[in] scores Objective values of the elements
+ * \param objectives Number of used objectives [1; \ref max_objectives]
+ * \param[in] rank Front index of every element (see \ref non_dominated_sort())
+ * \param fronts Number of fronts
+ * \param[out] dist Crowding distance of every element
+ * \param buf Reusable scratch memory
+ */
+void crowding_distance(const std::vector<Scores>& scores, std::size_t objectives, const std::vector<uint32_t>& rank,
+                       std::size_t fronts, std::vector<double>& dist, ParetoBuffers& buf);
+
+
+/**
+ * \brief Converts objective values to a single fitness value in range [0; 1]
+ * \headerfile ""
+ *
+ * Elements are ordered by their front and then by descending crowding distance (NSGA-II order).
+ * The best element gets fitness 1, the worst 0, the rest are spread evenly in between,
+ * so breeding and extinction thresholds select a fraction of the population.
+ *
+ * \param[in] scores Objective values of the elements
+ * \param objectives Number of used objectives [1; \ref max_objectives]
+ * \param[out] ftns Fitness of every element
+ * \param buf Reusable scratch memory
+ * \see non_dominated_sort() crowding_distance()
+ */
+void pareto_fitness(const std::vector<Scores>& scores, std::size_t objectives, std::vector<double>& ftns, ParetoBuffers& buf);
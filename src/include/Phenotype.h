@@ -75,6 +75,16 @@ public:
     Phenotype(const GenomeFrac& genome1, const GenomeFrac& genome2);
 
 
+    /**
+     * \brief constructor
+     * \param genome1 faction of a chromosome (pair of pointers)
+     * \param genome2 faction of a chromosome (pair of pointers)
+     * \param buffer genome whose memory is reused to store the new chromosome (its contents are discarded)
+     * \see GenomeFrac frac_front() frac_back() release_genome()
+     */
+    Phenotype(const GenomeFrac& genome1, const GenomeFrac& genome2, Genome&& buffer);
+
+
     /**
      * \brief Creates a \c GenomeFrac starting at the begining and ending at a random Gene
      * \return fraction of Genome (chromosome) starting at the begining and ending in a random place
@@ -99,6 +109,14 @@ public:
     const Genome& genome() const noexcept;
 
 
+    /**
+     * \brief Moves object's genome out (leaves the object with an empty genome)
+     * \return object's genome
+     * \see Genome
+     */
+    Genome release_genome() noexcept;
+
+
     /**
      * \brief Gets object's adaptation value
      * \return object's adaptation
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Phenotype.h"
+#include "Pareto.h"
 #include <cstdint>
 #include <vector>
 #include <filesystem>
@@ -35,10 +36,51 @@
 using FitnessFunction = double (*)(const Genome&);
 
 
+/**
+ * \brief Type for multi-objective fitness function
+ * 
+ * Evaluates several objectives of a \ref Phenotype "Phenotype" at once, e.g. a score and the genome length.
+ * \ref Population "Population" is then ranked by Pareto dominance and crowding distance (NSGA-II)
+ * and the position in that ranking is used as the fitness value.
+ * 
+ * \b Requirements:
+ * \li The parameter is a \ref Genome "const Genome&"
+ * \li returns \ref Scores "objective values", greater values are better
+ * 
+ * \see FitnessFunction pareto_fitness()
+ */
+using MultiFitnessFunction = Scores (*)(const Genome&);
+
+
 using Index = std::size_t; ///< Type for container indexes
 
 
 
+/**
+ * \brief Statistics of a single generation
+ * 
+ * Gathered by \ref Population::perform_selection() "selection" in the same pass that evaluates the
+ * \ref FitnessFunction "fitness function", so no additional passes over the population are needed.
+ * Fitness values describe every evaluated Phenotype, genome lengths and diversity describe the survivors.
+ * For \ref MultiFitnessFunction "multi-objective fitness" fitness values describe the first objective.
+ * 
+ * \see Population::stats()
+ */
+struct PopulationStats {
+    std::size_t evaluated { }; ///< Number of evaluated \ref Phenotype "Phenotypes"
+    std::size_t survivors { }; ///< Number of \ref Phenotype "Phenotypes" that were not \ref Adapt "removed"
+    std::size_t breeders { }; ///< Number of \ref Phenotype "Phenotypes" that can \ref Adapt "breed" (become parents after \ref Population::determine_breeding() "determining breeding")
+    double fitness_min { }; ///< Minimal fitness value
+    double fitness_mean { }; ///< Mean fitness value
+    double fitness_max { }; ///< Maximal fitness value
+    std::size_t genome_min { }; ///< Minimal \ref Genome "genome" length
+    double genome_mean { }; ///< Mean \ref Genome "genome" length
+    std::size_t genome_max { }; ///< Maximal \ref Genome "genome" length
+    double diversity { }; ///< Estimated number of distinct \ref Genome "genomes" (bottom-k sketch of genome hashes)
+};
+
+
+
 /**
  * \brief Represents a population and allows simulating its evolution
  * \headerfile ""
@@ -54,6 +96,24 @@ class Population
 private:
     PopulationVec _data; ///< Container that stores the population itself (\ref Phenotype "Phenotypes")
     std::vector<Index> _br; ///< Container that stores \ref Index "indexes" of (\ref Phenotype "Phenotypes") that can \ref Adapt "breed"
+    PopulationStats _stats; ///< Statistics gathered by the last \ref perform_selection() "selection"
+    std::vector<Genome> _pool; ///< \ref Genome "Genome" buffers of removed \ref Phenotype "Phenotypes", reused by descendants bred into this population
+    std::size_t _pool_len = 0; ///< Capacity that recycled \ref Genome "genome" buffers are grown to (at least the longest descendant bred into this population, doubled when exceeded)
+    bool _recycle = false; ///< If \c true \ref Genome "genome" buffers of removed \ref Phenotype "Phenotypes" are kept in \c _pool
+    std::vector<Scores> _scores; ///< Objective values of the last \ref perform_selection(MultiFitnessFunction, std::size_t, const double&, const double&) "multi-objective selection"
+    std::vector<double> _ftns; ///< Pareto fitness of the last multi-objective selection
+    ParetoBuffers _pareto; ///< Scratch memory of the Pareto ranking, reused by every multi-objective selection
+
+
+    /**
+     * \brief Common part of \ref perform_selection() "selections"
+     * \tparam Fitness Function of an \ref Index "index" returning a pair: fitness that determines \ref Adapt "adaptation" and value recorded in \ref stats() "statistics"
+     * \param fitness Fitness of the indexed \ref Phenotype "Phenotype"
+     * \param br_thr Breeding threshold [0; 1]
+     * \param ex_thr Extinctiom threshold [0; 1]
+     */
+    template<typename Fitness>
+    void select(Fitness fitness, const double& br_thr, const double& ex_thr);
 
 
 public:
@@ -61,6 +121,26 @@ public:
     ~Population() = default; ///< Default destructor
 
 
+    /**
+     * \brief Copy constructor
+     *
+     * Copies the \ref Phenotype "Phenotypes", breeding indexes, statistics and the recycling setting.
+     * Scratch state (recycled \ref Genome "genome" buffers and multi-objective selection buffers) is not copied,
+     * the copy starts with empty buffers.
+     *
+     * \param other Population to copy
+     */
+    Population(const Population& other);
+
+    /// \brief Copy assignment (scratch state is not copied, see \ref Population(const Population&))
+    /// \param other Population to copy
+    /// \return Reference to \c *this
+    Population& operator=(const Population& other);
+
+    Population(Population&&) noexcept = default; ///< Move constructor (moves the scratch state as well)
+    Population& operator=(Population&&) noexcept = default; ///< Move assignment (moves the scratch state as well)
+
+
     /// \brief Gets the underlying \c PopulationVec container
     /// \return \c PopulationVec reference
     const PopulationVec& get_population() const noexcept
@@ -78,6 +158,37 @@ public:
     { return _br; }
 
 
+    /// \brief Checks whether \ref Genome "genome" buffers of removed \ref Phenotype "Phenotypes" are recycled
+    /// \return \c true if recycling is enabled
+    bool recycle() const noexcept
+    { return _recycle; }
+
+
+    /**
+     * \brief Enables or disables recycling of \ref Genome "genome" buffers of removed \ref Phenotype "Phenotypes"
+     * 
+     * Recycled buffers are reused by descendants \ref perform_breeding() "bred" into this population,
+     * so it should be enabled only for populations that are used as a breeding target (new generations).
+     * Descendants are built in buffers as long as the longest descendant, both removed ones and the ones
+     * \ref operator+=(Population&&) "appended" elsewhere return their buffers. In steady state only the survivors
+     * allocate (one exactly sized genome each).
+     * Disabling it releases the kept buffers.
+     * 
+     * \param r \c true to enable recycling
+     */
+    void recycle(bool r) {
+        _recycle = r;
+        if (!r)
+            std::vector<Genome>().swap(_pool);
+    }
+
+
+    /// \brief Gets statistics gathered by the last \ref perform_selection() "selection"
+    /// \return \c PopulationStats reference
+    const PopulationStats& stats() const noexcept
+    { return _stats; }
+
+
     /**
      * \brief Appends \c other population to itself (appends by copying).
      * \brief Copying includes both PhenotypeVec and breeding phenotypes indexes. No other operations are performed.
@@ -98,6 +209,27 @@ public:
     Population& operator+=(const PopulationVec& range);
 
 
+    /**
+     * \brief Appends \c other population to itself (appends by moving).
+     * \brief Moving includes both PhenotypeVec and breeding phenotypes indexes. \c other is left empty,
+     * but keeps its capacity and recycled \ref Genome "genome" buffers, so it can be reused for the next generation.
+     * \brief If \c other \ref recycle() "recycles" genome buffers, appended Phenotypes get exactly sized copies of their genomes
+     * and the buffers return to the pool of \c other.
+     * \param other Population rvalue reference
+     * \return Refernce to itself
+     */
+    Population& operator+=(Population&& other);
+
+
+    /**
+     * \brief Appends \c PopulationVec to itself (appends by moving).
+     * \brief Also \ref determine_breeding() "determines breeding" \ref Phenotype "Phenotypes". No other operations are performed.
+     * \param range PopulationVec rvalue reference
+     * \return Refernce to itself
+     */
+    Population& operator+=(PopulationVec&& range);
+
+
     /// \copydoc operator+=(const Population&)
     Population& append(const Population& other);
 
@@ -106,6 +238,14 @@ public:
     Population& append(const PopulationVec& range);
 
 
+    /// \copydoc operator+=(Population&&)
+    Population& append(Population&& other);
+
+
+    /// \copydoc operator+=(PopulationVec&&)
+    Population& append(PopulationVec&& range);
+
+
     /**
      * \brief Adds two \c Populations.
      * \brief Adding includes breeding \ref Phenotype "Phenotypes". No other operations are performed.
@@ -125,7 +265,8 @@ public:
 
 
     /**
-     * \brief
+     * \brief Evaluates the population, removes the dead \ref Phenotype "Phenotypes" and gathers \ref stats() "statistics"
+     * \brief If \ref recycle() "recycling" is enabled, genome buffers of the removed \ref Phenotype "Phenotypes" are kept for reuse by \ref perform_breeding() "breeding".
      * \param f Function that checks phenotype fitness/adaptation (return values should be in range [0; 1])
      * \param br_thr Breeding threshold [0; 1]
      * \param ex_thr Extinctiom threshold [0; 1]
@@ -134,8 +275,21 @@ public:
     void perform_selection(FitnessFunction f, const double& br_thr, const double& ex_thr);
 
 
+    /**
+     * \brief Evaluates the population by several objectives, removes the dead \ref Phenotype "Phenotypes" and gathers \ref stats() "statistics"
+     * \brief Fitness is the position in the Pareto ranking (see \ref pareto_fitness()), so thresholds select a fraction of the population.
+     * \param f Function that evaluates phenotype objectives
+     * \param objectives Number of used objectives [1; \ref max_objectives] (checked by an assertion)
+     * \param br_thr Breeding threshold [0; 1]
+     * \param ex_thr Extinctiom threshold [0; 1]
+     * \see simulate_evolution() MultiFitnessFunction
+     */
+    void perform_selection(MultiFitnessFunction f, std::size_t objectives, const double& br_thr, const double& ex_thr);
+
+
     /**
      * \brief Performs breeding on an object's population
+     * \brief Descendants reuse the \ref Genome "genome" buffers recycled by \c other (if any are available).
      * \param pairs Number of pairs that will breed
      * \param[out] other Population reference where the descendants will be saved to (new generation)
      * \see simulate_evolution()
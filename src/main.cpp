@@ -34,7 +34,7 @@ int main(int argc, char** argv) {
         return handle_parsing_errors(argc, cli);
 
 
-    auto fitness = [](const Genome& gnm) -> double {
+    static auto fitness = [](const Genome& gnm) -> double {
         uint32_t sum { };
         for (auto& i : gnm)
             sum += i;
@@ -45,6 +45,12 @@ int main(int argc, char** argv) {
     };
 
 
+    // fitness versus genome length (shorter is better)
+    auto objectives = [](const Genome& gnm) -> Scores {
+        return { fitness(gnm), -static_cast<double>(gnm.size()) };
+    };
+
+
     Population sample;
     
     if (!read_population(options.infile, sample)) {
@@ -52,7 +58,14 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    simulate_evolution(options.r, options.w, options.k, options.p, fitness, sample);
+    GenerationObserver observer = nullptr;
+    if (options.stats)
+        observer = [](uint32_t generation, const PopulationStats& st) { write_stats(&std::clog, generation, st); };
+
+    if (options.pareto)
+        simulate_evolution(options.r, options.w, options.k, options.p, objectives, 2, sample, options.stop, observer);
+    else
+        simulate_evolution(options.r, options.w, options.k, options.p, fitness, sample, options.stop, observer);
     write_population(options.outfile, sample);
 
     if (options.writeout)
@@ -0,0 +1,157 @@
+/**
+ * \file alloc_test.cpp
+ * \brief Checks heap allocations of the steady-state generation loop of \ref simulate_evolution()
+ *
+ * After warm-up descendants removed by selection must cost no allocations, so a generation may allocate
+ * at most one genome per survivor (survivors stay in the population) plus amortised growth
+ * of the population containers. If every descendant is removed, the loop performs no allocations.
+ *
+ * \author Paweł Rapacz
+ * \date 01-2025
+ */
+
+
+#include "Darwin.h"
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+
+static std::size_t allocations = 0; ///< Number of calls to the replaced \c operator \c new
+static bool kill_all = false; ///< If \c true \ref all_dead() removes every Phenotype
+
+
+void* operator new(std::size_t n) {
+    allocations++;
+    if (void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n)
+{ return operator new(n); }
+
+void operator delete(void* p) noexcept
+{ std::free(p); }
+
+void operator delete[](void* p) noexcept
+{ std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept
+{ std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept
+{ std::free(p); }
+
+
+
+/// \brief Fitness function that lets every Phenotype breed or, if \c kill_all is set, removes every Phenotype
+double all_dead(const Genome&)
+{ return kill_all ? 0. : 1.; }
+
+
+/// \brief Fitness function that keeps (and breeds) Phenotypes with at most 20 genes and removes the longer ones
+double mixed(const Genome& gnm)
+{ return gnm.size() <= 20 ? 1. : 0.; }
+
+
+/// \brief Multi-objective version of \ref mixed() (short genomes dominate the long ones)
+Scores mixed_objectives(const Genome& gnm)
+{ return { mixed(gnm), -static_cast<double>(gnm.size()) }; }
+
+
+
+/// \brief Allocations measured between the end of the warm-up and the end of the simulation
+struct Measure {
+    uint32_t warmup; ///< Generation that ends the warm-up
+    uint32_t last; ///< Last simulated generation
+    std::size_t before; ///< Allocation count at the end of the warm-up
+    std::size_t after; ///< Allocation count at the end of the simulation
+    std::size_t survivors; ///< Number of descendants that survived after the warm-up
+};
+
+static Measure measure; ///< Measurement of the running simulation
+
+
+/// \brief \ref GenerationObserver "Observer" that records allocations of the steady-state generations
+void observe(uint32_t generation, const PopulationStats& st) {
+    if (0 == generation)
+        kill_all = true; // the initial population survives, the descendants do not
+
+    if (generation == measure.warmup)
+        measure.before = allocations;
+    else if (generation > measure.warmup)
+        measure.survivors += st.survivors;
+
+    if (generation == measure.last)
+        measure.after = allocations;
+}
+
+
+/// \brief Creates 200 Phenotypes with 20 genes each
+Population initial_population() {
+    Population p;
+    for (int i = 0; i < 200; i++) {
+        std::string genome;
+        for (int g = 0; g < 20; g++)
+            genome += std::to_string((i * 31 + g * 7) % 1000) + ' ';
+        p.data().emplace_back(genome);
+    }
+    return p;
+}
+
+
+/**
+ * \brief Runs the simulation and checks its steady-state allocations
+ * \param name Name of the case
+ * \param simulate Function that runs \ref simulate_evolution() with the given observer
+ * \return \c true if the allocations are within the bound
+ */
+template<typename Simulate>
+bool check(const char* name, Simulate simulate) {
+    constexpr uint32_t warmup = 50;
+    constexpr uint32_t generations = 1000;
+
+    Population population = initial_population();
+    kill_all = false;
+    measure = { warmup, warmup + generations, 0, 0, 0 };
+
+    if (simulate(population, warmup + generations) != warmup + generations) {
+        std::cout << name << ": simulation ended early\n";
+        return false;
+    }
+
+    // population containers (Phenotypes and breeding indexes) grow geometrically
+    std::size_t initial = initial_population().data().size();
+    std::size_t final = population.data().size();
+    std::size_t growth = final > initial ? 2 * (std::bit_width(final) - std::bit_width(initial) + 1) : 0;
+    std::size_t steady = measure.after - measure.before;
+    bool ok = steady <= measure.survivors + growth;
+
+    std::cout << name << ": " << steady << " allocations in " << generations << " generations after warm-up, "
+              << measure.survivors << " survivors, bound " << measure.survivors + growth << (ok ? "" : " EXCEEDED") << '\n';
+    return ok;
+}
+
+
+int main() {
+    constexpr uint32_t pairs = 100;
+    bool ok = true;
+
+    ok &= check("all removed", [](Population& p, uint32_t generations) {
+        return simulate_evolution(.5, .5, pairs, generations, all_dead, p, { }, observe);
+    });
+
+    ok &= check("mixed", [](Population& p, uint32_t generations) {
+        return simulate_evolution(.5, .5, pairs, generations, mixed, p, { }, observe);
+    });
+
+    // thresholds are fractions of the Pareto ranking, long genomes are below 60%
+    ok &= check("mixed multi-objective", [](Population& p, uint32_t generations) {
+        return simulate_evolution(.6, .6, pairs, generations, mixed_objectives, 2, p, { }, observe);
+    });
+
+    return ok ? 0 : 1;
+}
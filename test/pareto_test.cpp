@@ -0,0 +1,165 @@
+/**
+ * \file pareto_test.cpp
+ * \brief Checks Pareto ranking against a brute-force non-dominated sorting
+ *
+ * Random inputs with 1-4 objectives, many ties and duplicates, empty and single-element inputs.
+ * Every input with more than two objectives is also sorted with forced worker threads,
+ * so the parallel path is used even on a single-core machine.
+ *
+ * \author Paweł Rapacz
+ * \date 01-2025
+ */
+
+
+#include "Pareto.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+
+/// \brief Checks whether \c a dominates \c b
+bool dominates(const Scores& a, const Scores& b, std::size_t objectives) {
+    bool better = false;
+    for (std::size_t k = 0; k < objectives; k++) {
+        if (a[k] < b[k])
+            return false;
+        if (a[k] > b[k])
+            better = true;
+    }
+    return better;
+}
+
+
+/**
+ * \brief O(N^2) per front non-dominated sorting (repeatedly removes elements not dominated by any remaining one)
+ * \param[in] scores Objective values of the elements
+ * \param objectives Number of used objectives
+ * \param[out] rank Front index of every element
+ * \return Number of fronts
+ */
+std::size_t brute_sort(const std::vector<Scores>& scores, std::size_t objectives, std::vector<uint32_t>& rank) {
+    const std::size_t n = scores.size();
+    std::vector<bool> ranked(n);
+    std::vector<std::size_t> front;
+    rank.assign(n, 0);
+
+    std::size_t left = n;
+    uint32_t fronts = 0;
+    while (left) {
+        front.clear();
+        for (std::size_t i = 0; i < n; i++) {
+            if (ranked[i])
+                continue;
+
+            bool dominated = false;
+            for (std::size_t j = 0; j < n && !dominated; j++)
+                dominated = !ranked[j] && dominates(scores[j], scores[i], objectives);
+
+            if (!dominated)
+                front.push_back(i);
+        }
+
+        for (std::size_t i : front) {
+            rank[i] = fronts;
+            ranked[i] = true;
+        }
+        left -= front.size();
+        fronts++;
+    }
+
+    return fronts;
+}
+
+
+/**
+ * \brief Checks ranking, crowding distance and fitness of a single input
+ * \param scores Objective values of the elements
+ * \param objectives Number of used objectives
+ * \param threads Forced number of threads (0 - default)
+ * \return Description of the first failure (empty if everything is correct)
+ */
+std::string check(const std::vector<Scores>& scores, std::size_t objectives, std::size_t threads) {
+    ParetoBuffers buf;
+    buf.threads = threads;
+
+    std::vector<uint32_t> expected, rank;
+    std::size_t expected_fronts = brute_sort(scores, objectives, expected);
+    std::size_t fronts = non_dominated_sort(scores, objectives, rank, buf);
+
+    if (fronts != expected_fronts)
+        return "number of fronts " + std::to_string(fronts) + ", expected " + std::to_string(expected_fronts);
+    if (rank != expected)
+        return "ranks differ from brute force";
+
+    std::vector<double> dist;
+    crowding_distance(scores, objectives, rank, fronts, dist, buf);
+    for (double d : dist)
+        if (std::isnan(d) || d < 0)
+            return "invalid crowding distance";
+
+    std::vector<double> ftns;
+    pareto_fitness(scores, objectives, ftns, buf);
+    if (ftns.size() != scores.size())
+        return "wrong number of fitness values";
+
+    for (std::size_t i = 0; i < ftns.size(); i++) {
+        if (!(ftns[i] >= 0. && ftns[i] <= 1.))
+            return "fitness out of range [0; 1]";
+        for (std::size_t j = 0; j < ftns.size(); j++)
+            if (rank[i] < rank[j] && ftns[i] <= ftns[j])
+                return "better front has lower fitness";
+    }
+
+    if (1 == ftns.size() && 1. != ftns[0])
+        return "single element fitness is not 1";
+
+    return { };
+}
+
+
+int main() {
+    std::mt19937 rand(2025);
+    std::size_t cases = 0, failures = 0;
+
+    auto run = [&](const std::vector<Scores>& scores, std::size_t objectives, const char* kind) {
+        for (std::size_t threads : { std::size_t { 0 }, std::size_t { 4 } }) {
+            if (threads && objectives <= 2)
+                continue; // sweep sorting does not use threads
+
+            cases++;
+            std::string error = check(scores, objectives, threads);
+            if (!error.empty()) {
+                failures++;
+                std::cout << kind << ", " << scores.size() << " elements, " << objectives << " objectives, "
+                          << threads << " threads: " << error << '\n';
+            }
+        }
+    };
+
+    for (std::size_t objectives = 1; objectives <= max_objectives; objectives++) {
+        run({ }, objectives, "empty");
+        run({ Scores { 1., 2., 3., 4. } }, objectives, "single");
+        run(std::vector<Scores>(50, Scores { 1., 1., 1., 1. }), objectives, "identical");
+
+        for (int i = 0; i < 250; i++) {
+            std::vector<Scores> scores(rand() % 120 + 1);
+
+            // few distinct values, so there are many ties and duplicates
+            std::uniform_int_distribution<int> tied(0, 4);
+            for (auto& s : scores)
+                for (auto& v : s)
+                    v = tied(rand);
+            run(scores, objectives, "tied");
+
+            std::uniform_real_distribution<double> real(-1., 1.);
+            for (auto& s : scores)
+                for (auto& v : s)
+                    v = real(rand);
+            run(scores, objectives, "random");
+        }
+    }
+
+    std::cout << cases << " cases, " << failures << " failures\n";
+    return failures ? 1 : 0;
+}